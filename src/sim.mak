@@ -0,0 +1,201 @@
+# sim.mak
+# Makefile for the PC simulator build of the digital filter chain
+# (gcc/Linux). The target image is still built by makefile.mak.
+#
+#   make -f sim.mak          - libdfm.a, the benchmark drivers, the
+#                              btch_dfm batch analyser, bnch_pll,
+#                              bnch_drm, bnch_rice and bnch_sdft
+#   make -f sim.mak bench    - run the benchmarks against the recorded
+#                              checksums (fails if the output changes)
+#   make -f sim.mak VECFLAGS=-march=native bench
+#                            - the lobe vector builds for this cpu
+#   make -f sim.mak hf       - regenerate filters/*.HF from the FDAS
+#                              *.FLT files with prc_fdas
+#   make -f sim.mak clean
+#
+# The sources #include lower case names for the upper case files in
+# h/ and filters/, so a directory of lower case links is made first.
+
+CC       = gcc
+# The sources predate prototypes - implicit int, nested comments, the
+# IC96 pragmas and the filter tables' initialisers are left alone
+WARN     = -Wall -Wno-implicit-int -Wno-comment -Wno-unknown-pragmas \
+           -Wno-multichar -Wno-missing-braces -Wno-discarded-qualifiers
+KERNELS  = -DDFM_FILTER_KERNELS # prc_fdas kernels, see dfm_ikrn.c
+SDFT     = -DDFM_SDFT_ENGINE    # sliding DFT band engine, see dfm_sdft.c
+CFLAGS   = -std=c99 -O2 $(WARN) $(KERNELS) $(SDFT)
+OBJ      = sim_obj
+INC      = $(OBJ)/inc
+CPPFLAGS = -I$(INC)
+LDLIBS   = -lm  # dfm_sdft.c and the benchmarks
+HDRS     = $(wildcard h/*.H filters/*.HF filters/FILTERS.H)
+
+# Digital filter chain - dfm_schedule() and the modules it calls
+DFM_SRCS = DFM_MNG.C DFM_I.C DFM_I196.C DFM_IPC.C DFM_IVEC.C DFM_IKRN.C \
+           DFM_SDFT.C IN_RAM.C DIM.C DIM_RICE.C DBG_PRF.C SIM_HW.C
+DFM_OBJS = $(DFM_SRCS:%.C=$(OBJ)/%.o)
+DFM_LIB  = $(OBJ)/libdfm.a
+
+# Streams, timing and checksums shared by the programs using the chain
+SIM_SRCS = SIM_STRM.C
+
+# Variants of the filter chain, each built in its own directory
+#   vec, vec16, vec32 - lobe vector filter state (DFM_LOBE_VECTOR) for
+#                       the target's two lobes and for wide montages.
+#                       VECFLAGS picks the vector instruction set, the
+#                       default is the baseline for the host.
+#   r512, r1024       - 512Hz and 1024Hz input (see decimation_tree[])
+#   desc, vecdesc     - the filters worked through their descriptors,
+#                       without the prc_fdas kernels, for comparison
+VECFLAGS  =
+VEC_FLAGS = -O3 -DDFM_LOBE_VECTOR $(VECFLAGS)
+VARIANTS  = $(OBJ)/vec $(OBJ)/vec16 $(OBJ)/vec32 $(OBJ)/r512 $(OBJ)/r1024 \
+            $(OBJ)/desc $(OBJ)/vecdesc
+$(OBJ)/vec/%.o:   VARIANT_FLAGS = $(VEC_FLAGS)
+$(OBJ)/vec16/%.o: VARIANT_FLAGS = $(VEC_FLAGS) -DNUMBER_LOBES=16
+$(OBJ)/vec32/%.o: VARIANT_FLAGS = $(VEC_FLAGS) -DNUMBER_LOBES=32
+$(OBJ)/r512/%.o:  VARIANT_FLAGS = -DSAMPLING_FREQUENCY=512
+$(OBJ)/r1024/%.o: VARIANT_FLAGS = -DSAMPLING_FREQUENCY=1024
+$(OBJ)/desc/%.o:  VARIANT_FLAGS = -UDFM_FILTER_KERNELS
+$(OBJ)/vecdesc/%.o: VARIANT_FLAGS = $(VEC_FLAGS) -UDFM_FILTER_KERNELS
+
+# Filter include files made by prc_fdas (see filters/makefile.mak)
+FILTER_HFS = 340_00T1 270_70B1 215_55B1 170_45B1 135_35B1 115_20B1 \
+             095_20B1 079_16B1 068_11S 053_16B 037_16B 023_14B \
+             011_12B 005__5S1 2560_LPI 1280_LPI 640_LPI 320_LPI 160_LPI
+
+# Benchmark drivers and the checksum they must reproduce. The stream
+# is loud enough to wrap the narrowest band pass filters, as on the
+# target; the descriptor build must wrap BNCH_DFM_WRAPS results a run.
+BNCH_DFM_CHECKSUM = 05559b66
+BNCH_DFM16_CHECKSUM = 4107389d
+BNCH_DFM32_CHECKSUM = 3aaaf93d
+BNCH_DFM512_CHECKSUM = a214beb8
+BNCH_DFM1024_CHECKSUM = ec655b24
+BNCH_DFM_WRAPS = 4229
+
+BENCHES  = $(OBJ)/bnch_dfm $(VARIANTS:%=%/bnch_dfm)
+
+# Batch analysis of recordings - checked against the bnch_dfm lobe
+# checksums of the stream it records, BNCH_STREAM
+BTCH_DFM = $(OBJ)/btch_dfm
+BNCH_STREAM = $(OBJ)/bnch.stm
+BNCH_DFM_LOBE_CHECKSUMS = b755e1a1,94d0848e
+
+# Serial link receiver (pll_rx.c) and its benchmark, which replays a
+# capture written with faults in it, PLL_CAPTURE, in big buffers and
+# in buffers smaller than a frame
+PLL_SRCS = PLL_RX.C
+BNCH_PLL = $(OBJ)/bnch_pll
+PLL_CAPTURE = $(OBJ)/bnch.pll
+PLL_CAPTURE_MBYTES = 64
+
+# Block compressed recording (drm_blk.c) and its benchmark, which
+# records into a file the size of the banked ram and checks it
+DRM_SRCS = DRM_BLK.C
+BNCH_DRM = $(OBJ)/bnch_drm
+DRM_RECORDING = $(OBJ)/bnch.drm
+
+# Rice coded raw data (dim_rice.c), coded by DimSnapRaw() and decoded
+# as on the PC
+BNCH_RICE = $(OBJ)/bnch_rice
+
+# Sliding DFT band engine (dfm_sdft.c), timed and compared with the
+# band pass filters, for the target's lobes and a wide montage. Every
+# band is checked, so the stream is bnch_sdft's own, with a signal in
+# every band, written out and read back
+BNCH_SDFT = $(OBJ)/bnch_sdft
+BNCH_SDFT32 = $(OBJ)/vec32/bnch_sdft
+SDFT_STREAM = $(OBJ)/sdft.stm
+
+all: $(DFM_LIB) $(BENCHES) $(BTCH_DFM) $(BNCH_PLL) $(BNCH_DRM) $(BNCH_RICE) \
+     $(BNCH_SDFT) $(BNCH_SDFT32)
+
+$(INC)/.made: $(HDRS)
+	mkdir -p $(INC)
+	for f in h/*.H filters/*.HF filters/FILTERS.H; do \
+	   b=`basename $$f`; s=$${b%.*}; e=$${b##*.}; \
+	   ln -sf ../../$$f $(INC)/`echo $$b | tr A-Z a-z`; \
+	   ln -sf ../../$$f $(INC)/$$s.`echo $$e | tr A-Z a-z`; \
+	done
+	touch $@
+
+$(OBJ)/%.o: %.C $(INC)/.made $(HDRS)
+	$(CC) $(CFLAGS) $(CPPFLAGS) -x c -c $< -o $@
+
+$(DFM_LIB): $(DFM_OBJS)
+	rm -f $@
+	ar rcs $@ $^
+
+$(OBJ)/bnch_dfm: $(OBJ)/BNCH_DFM.o $(SIM_SRCS:%.C=$(OBJ)/%.o) $(DFM_LIB)
+	$(CC) -o $@ $^ $(LDLIBS)
+
+$(BTCH_DFM): $(OBJ)/BTCH_DFM.o $(SIM_SRCS:%.C=$(OBJ)/%.o) $(DFM_LIB)
+	$(CC) -pthread -o $@ $^ $(LDLIBS)
+
+$(BNCH_PLL): $(OBJ)/BNCH_PLL.o $(PLL_SRCS:%.C=$(OBJ)/%.o)
+	$(CC) -o $@ $^ $(LDLIBS)
+
+$(BNCH_DRM): $(OBJ)/BNCH_DRM.o $(DRM_SRCS:%.C=$(OBJ)/%.o)
+	$(CC) -o $@ $^ $(LDLIBS)
+
+$(BNCH_RICE): $(OBJ)/BNCH_RICE.o $(DFM_LIB)
+	$(CC) -o $@ $^ $(LDLIBS)
+
+$(BNCH_SDFT): $(OBJ)/BNCH_SDFT.o $(SIM_SRCS:%.C=$(OBJ)/%.o) $(DFM_LIB)
+	$(CC) -o $@ $^ $(LDLIBS)
+
+# Objects and benchmark of one variant, in directory $(1)
+define variant_build
+$(1)/%.o: %.C $(INC)/.made $(HDRS)
+	@mkdir -p $(1)
+	$$(CC) $$(CFLAGS) $$(VARIANT_FLAGS) $$(CPPFLAGS) -x c -c $$< -o $$@
+
+$(1)/bnch_dfm: $(1)/BNCH_DFM.o $(SIM_SRCS:%.C=$(1)/%.o) \
+               $(DFM_SRCS:%.C=$(1)/%.o)
+	$$(CC) -o $$@ $$^ $$(LDLIBS)
+
+$(1)/bnch_sdft: $(1)/BNCH_SDFT.o $(SIM_SRCS:%.C=$(1)/%.o) \
+                $(DFM_SRCS:%.C=$(1)/%.o)
+	$$(CC) -o $$@ $$^ $$(LDLIBS)
+endef
+$(foreach dir,$(VARIANTS),$(eval $(call variant_build,$(dir))))
+
+# gcvt() is an X/Open extension, hence gnu99. prc_fdas is the DOS
+# tool, unsigned char strings and all, so its warnings are off.
+$(OBJ)/prc_fdas: filters/PRC_FDAS.C filters/CONV.C $(INC)/.made
+	$(CC) -std=gnu99 -O2 -w $(CPPFLAGS) -x c \
+	   filters/PRC_FDAS.C filters/CONV.C -o $@
+
+hf: $(OBJ)/prc_fdas
+	cd filters && for f in $(FILTER_HFS); do \
+	   ../$(OBJ)/prc_fdas $$f.FLT > /dev/null && mv $$f.hf $$f.HF || exit 1; \
+	done
+
+bench: $(BENCHES) $(BTCH_DFM) $(BNCH_PLL) $(BNCH_DRM) $(BNCH_RICE) \
+       $(BNCH_SDFT) $(BNCH_SDFT32)
+	$(OBJ)/bnch_dfm -n 3 -p -c $(BNCH_DFM_CHECKSUM)
+	$(OBJ)/vec/bnch_dfm -n 3 -c $(BNCH_DFM_CHECKSUM)
+	$(OBJ)/vec16/bnch_dfm -n 3 -c $(BNCH_DFM16_CHECKSUM)
+	$(OBJ)/vec32/bnch_dfm -n 3 -c $(BNCH_DFM32_CHECKSUM)
+	$(OBJ)/r512/bnch_dfm -n 3 -c $(BNCH_DFM512_CHECKSUM)
+	$(OBJ)/r1024/bnch_dfm -n 3 -c $(BNCH_DFM1024_CHECKSUM)
+	$(OBJ)/desc/bnch_dfm -n 3 -c $(BNCH_DFM_CHECKSUM) -W $(BNCH_DFM_WRAPS)
+	$(OBJ)/vecdesc/bnch_dfm -n 3 -c $(BNCH_DFM_CHECKSUM)
+	$(OBJ)/bnch_dfm -w $(BNCH_STREAM) > /dev/null
+	$(BTCH_DFM) -T -t 8 -r 8 -q -c $(BNCH_DFM_LOBE_CHECKSUMS) $(BNCH_STREAM)
+	$(BNCH_PLL) -w $(PLL_CAPTURE) -m $(PLL_CAPTURE_MBYTES)
+	$(BNCH_PLL) -n 3 -c $(PLL_CAPTURE)
+	$(BNCH_PLL) -b 61 -c $(PLL_CAPTURE)
+	$(BNCH_DRM) -n 20000 -c -f $(DRM_RECORDING)
+	$(BNCH_DRM) -n 20000 -q -c
+	$(BNCH_DRM) -k 64 -n 20000 -c
+	$(BNCH_RICE) -c
+	$(BNCH_SDFT) -w $(SDFT_STREAM) -c
+	$(BNCH_SDFT) -f $(SDFT_STREAM) -c
+	$(BNCH_SDFT32) -s 60 -c
+
+clean:
+	rm -rf $(OBJ)
+
+.PHONY: all bench hf clean